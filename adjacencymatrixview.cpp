@@ -0,0 +1,119 @@
+#include "adjacencymatrixview.h"
+#include <QHeaderView>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QLabel>
+
+AdjacencyMatrixModel::AdjacencyMatrixModel(Graph& graph, QObject* parent)
+    : QAbstractTableModel(parent)
+    , graph(graph)
+{
+}
+
+int AdjacencyMatrixModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : graph.getNumVertices();
+}
+
+int AdjacencyMatrixModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : graph.getNumVertices();
+}
+
+// Вес ребра читается только для видимых ячеек
+QVariant AdjacencyMatrixModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::EditRole)) {
+        return QVariant();
+    }
+    return graph.getEdgeWeight(index.row(), index.column());
+}
+
+QVariant AdjacencyMatrixModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    Q_UNUSED(orientation);
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    return section;
+}
+
+// Изменение веса ребра; матрица симметрична, поэтому обновляются обе ячейки
+bool AdjacencyMatrixModel::setData(const QModelIndex& index, const QVariant& value, int role) {
+    if (!index.isValid() || role != Qt::EditRole) {
+        return false;
+    }
+    bool ok;
+    int weight = value.toInt(&ok);
+    if (!ok || weight < 0) {
+        return false;
+    }
+    int v1 = index.row();
+    int v2 = index.column();
+    graph.editEdgeWeight(v1, v2, weight);
+    emit dataChanged(index, index);
+    QModelIndex mirrored = this->index(v2, v1);
+    emit dataChanged(mirrored, mirrored);
+    emit edgeWeightChanged(v1, v2);
+    return true;
+}
+
+Qt::ItemFlags AdjacencyMatrixModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+    Qt::ItemFlags itemFlags = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+    // Вес петли не редактируется
+    if (index.row() != index.column()) {
+        itemFlags |= Qt::ItemIsEditable;
+    }
+    return itemFlags;
+}
+
+AdjacencyMatrixDialog::AdjacencyMatrixDialog(Graph& graph, QWidget* parent)
+    : QDialog(parent)
+{
+    setWindowTitle("Матрица смежности");
+    resize(900, 700);
+
+    model = new AdjacencyMatrixModel(graph, this);
+    connect(model, &AdjacencyMatrixModel::edgeWeightChanged, this, [this](int v1, int v2) { edges.emplace_back(v1, v2); });
+
+    tableView = new QTableView(this);
+    tableView->setModel(model);
+    // Фиксированный размер секций: представление не измеряет содержимое всех строк и столбцов
+    tableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    tableView->horizontalHeader()->setDefaultSectionSize(60);
+    tableView->verticalHeader()->setDefaultSectionSize(24);
+
+    // Переход к вершине
+    vertexSpinBox = new QSpinBox(this);
+    vertexSpinBox->setRange(0, qMax(0, graph.getNumVertices() - 1));
+    goToButton = new QPushButton("Перейти", this);
+    connect(goToButton, &QPushButton::clicked, this, &AdjacencyMatrixDialog::goToVertex);
+    connect(vertexSpinBox, &QSpinBox::editingFinished, this, &AdjacencyMatrixDialog::goToVertex);
+
+    QHBoxLayout* searchLayout = new QHBoxLayout;
+    searchLayout->addWidget(new QLabel("Вершина", this));
+    searchLayout->addWidget(vertexSpinBox);
+    searchLayout->addWidget(goToButton);
+    searchLayout->addStretch();
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->addLayout(searchLayout);
+    layout->addWidget(tableView);
+}
+
+// Рёбра, вес которых был изменён в окне
+const std::vector<std::pair<int, int>>& AdjacencyMatrixDialog::changedEdges() const {
+    return edges;
+}
+
+// Прокрутка к строке и столбцу выбранной вершины
+void AdjacencyMatrixDialog::goToVertex() {
+    int vertex = vertexSpinBox->value();
+    if (vertex >= model->rowCount()) {
+        return;
+    }
+    QModelIndex index = model->index(vertex, vertex);
+    tableView->setCurrentIndex(index);
+    tableView->selectRow(vertex);
+    tableView->scrollTo(index, QAbstractItemView::PositionAtCenter);
+}
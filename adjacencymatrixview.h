@@ -0,0 +1,54 @@
+#ifndef ADJACENCYMATRIXVIEW_H
+#define ADJACENCYMATRIXVIEW_H
+
+#include <QAbstractTableModel>
+#include <QDialog>
+#include <QTableView>
+#include <QSpinBox>
+#include <QPushButton>
+#include <utility>
+#include <vector>
+#include "graph.h"
+
+// Модель матрицы смежности: ячейки читаются из графа по запросу, без копирования
+class AdjacencyMatrixModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    AdjacencyMatrixModel(Graph& graph, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+signals:
+    void edgeWeightChanged(int v1, int v2);
+
+private:
+    Graph& graph;
+};
+
+// Окно просмотра и редактирования матрицы смежности
+class AdjacencyMatrixDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    AdjacencyMatrixDialog(Graph& graph, QWidget* parent = nullptr);
+
+    const std::vector<std::pair<int, int>>& changedEdges() const;
+
+private slots:
+    void goToVertex();
+
+private:
+    AdjacencyMatrixModel* model;
+    QTableView* tableView;
+    QSpinBox* vertexSpinBox;
+    QPushButton* goToButton;
+    std::vector<std::pair<int, int>> edges;   // Рёбра, вес которых был изменён
+};
+
+#endif // ADJACENCYMATRIXVIEW_H
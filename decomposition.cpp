@@ -0,0 +1,326 @@
+#include "decomposition.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <thread>
+using namespace std;
+
+namespace {
+
+// Порядок кривой Гильберта: сетка 2^16 x 2^16
+const uint32_t hilbertSide = 1u << 16;
+
+// Предельное число кластеров, для которых мета-маршрут улучшается 2-opt
+const int maxMetaTourClusters = 5000;
+
+inline double distance(const Point2D& a, const Point2D& b) {
+    return hypot(a.x - b.x, a.y - b.y);
+}
+
+// Номер клетки (x, y) вдоль кривой Гильберта
+uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+    uint64_t d = 0;
+    for (uint32_t s = hilbertSide / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += uint64_t(s) * s * ((3 * rx) ^ ry);
+        // Поворот квадранта
+        if (ry == 0) {
+            if (rx == 1) {
+                x = hilbertSide - 1 - x;
+                y = hilbertSide - 1 - y;
+            }
+            swap(x, y);
+        }
+    }
+    return d;
+}
+
+// Улучшение замкнутого маршрута по точкам ids методом 2-opt
+void twoOptCycle(const vector<Point2D>& points, vector<int>& cycle) {
+    const int m = cycle.size();
+    if (m < 4) {
+        return;
+    }
+    bool improved = true;
+    for (int pass = 0; improved && pass < 50; pass++) {
+        improved = false;
+        for (int i = 0; i < m - 2; i++) {
+            const Point2D& a = points[cycle[i]];
+            const Point2D& b = points[cycle[i + 1]];
+            const double ab = distance(a, b);
+            for (int j = i + 2; j < m; j++) {
+                if (i == 0 && j == m - 1) {
+                    continue;
+                }
+                const Point2D& c = points[cycle[j]];
+                const Point2D& d = points[cycle[(j + 1) % m]];
+                double delta = distance(a, c) + distance(b, d) - ab - distance(c, d);
+                if (delta < -1e-9) {
+                    reverse(cycle.begin() + i + 1, cycle.begin() + j + 1);
+                    improved = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Маршрут ближайшего соседа по точкам ids с последующим 2-opt
+vector<int> solveCycle(const vector<Point2D>& points, const vector<int>& ids) {
+    const int m = ids.size();
+    vector<int> cycle;
+    cycle.reserve(m);
+    if (m == 0) {
+        return cycle;
+    }
+
+    vector<bool> visited(m, false);
+    int current = 0;
+    visited[0] = true;
+    cycle.push_back(ids[0]);
+    for (int step = 1; step < m; step++) {
+        int next = -1;
+        double minDistance = numeric_limits<double>::max();
+        for (int j = 0; j < m; j++) {
+            if (!visited[j]) {
+                double dist = distance(points[ids[current]], points[ids[j]]);
+                if (dist < minDistance) {
+                    minDistance = dist;
+                    next = j;
+                }
+            }
+        }
+        visited[next] = true;
+        cycle.push_back(ids[next]);
+        current = next;
+    }
+
+    twoOptCycle(points, cycle);
+    return cycle;
+}
+
+// 2-opt внутри окна [lo, hi) разомкнутого представления маршрута
+void twoOptWindow(const vector<Point2D>& points, vector<int>& tour, int lo, int hi) {
+    const int n = tour.size();
+    hi = min(hi, n - 1);
+    bool improved = true;
+    for (int pass = 0; improved && pass < 10; pass++) {
+        improved = false;
+        for (int i = lo; i < hi - 1; i++) {
+            const Point2D& a = points[tour[i]];
+            const Point2D& b = points[tour[i + 1]];
+            const double ab = distance(a, b);
+            for (int j = i + 2; j < hi; j++) {
+                const Point2D& c = points[tour[j]];
+                const Point2D& d = points[tour[j + 1]];
+                double delta = distance(a, c) + distance(b, d) - ab - distance(c, d);
+                if (delta < -1e-9) {
+                    reverse(tour.begin() + i + 1, tour.begin() + j + 1);
+                    improved = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+double tourLength(const vector<Point2D>& points, const vector<int>& tour) {
+    double length = 0;
+    const int n = tour.size();
+    for (int i = 0; i < n; i++) {
+        length += distance(points[tour[i]], points[tour[(i + 1) % n]]);
+    }
+    return length;
+}
+
+DecompositionResult solveByDecomposition(const vector<Point2D>& points, const DecompositionOptions& options) {
+    DecompositionResult result;
+    const int n = points.size();
+    if (n == 0) {
+        return result;
+    }
+
+    const int clusterSize = max(options.clusterSize, 2);
+
+    // Небольшой экземпляр решается целиком
+    if (n <= clusterSize) {
+        vector<int> ids(n);
+        for (int i = 0; i < n; i++) {
+            ids[i] = i;
+        }
+        result.tour = solveCycle(points, ids);
+        result.length = tourLength(points, result.tour);
+        result.numClusters = 1;
+        return result;
+    }
+
+    // Упорядочивание вершин вдоль кривой Гильберта
+    double minX = points[0].x, maxX = points[0].x;
+    double minY = points[0].y, maxY = points[0].y;
+    for (const Point2D& p : points) {
+        minX = min(minX, p.x);
+        maxX = max(maxX, p.x);
+        minY = min(minY, p.y);
+        maxY = max(maxY, p.y);
+    }
+    const double span = max(max(maxX - minX, maxY - minY), 1e-12);
+    const double scale = (hilbertSide - 1) / span;
+
+    vector<pair<uint64_t, int>> keys(n);
+    for (int i = 0; i < n; i++) {
+        uint32_t hx = uint32_t((points[i].x - minX) * scale);
+        uint32_t hy = uint32_t((points[i].y - minY) * scale);
+        keys[i] = make_pair(hilbertIndex(hx, hy), i);
+    }
+    sort(keys.begin(), keys.end());
+
+    // Разбиение на кластеры примерно равного размера
+    const int numClusters = (n + clusterSize - 1) / clusterSize;
+    vector<vector<int>> clusters(numClusters);
+    vector<Point2D> centroids(numClusters, Point2D{0, 0});
+    for (int c = 0; c < numClusters; c++) {
+        int first = int(int64_t(n) * c / numClusters);
+        int last = int(int64_t(n) * (c + 1) / numClusters);
+        clusters[c].reserve(last - first);
+        for (int k = first; k < last; k++) {
+            int v = keys[k].second;
+            clusters[c].push_back(v);
+            centroids[c].x += points[v].x;
+            centroids[c].y += points[v].y;
+        }
+        centroids[c].x /= last - first;
+        centroids[c].y /= last - first;
+    }
+    keys.clear();
+    keys.shrink_to_fit();
+
+    // Параллельное решение кластеров
+    vector<vector<int>> cycles(numClusters);
+    int numThreads = options.numThreads > 0 ? options.numThreads : int(thread::hardware_concurrency());
+    numThreads = max(1, min(numThreads, numClusters));
+    atomic<int> nextCluster(0);
+    auto worker = [&]() {
+        for (int c = nextCluster++; c < numClusters; c = nextCluster++) {
+            cycles[c] = solveCycle(points, clusters[c]);
+        }
+    };
+    vector<thread> threads;
+    for (int t = 1; t < numThreads; t++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (thread& t : threads) {
+        t.join();
+    }
+    clusters.clear();
+
+    // Мета-маршрут по центрам кластеров
+    vector<int> order(numClusters);
+    for (int c = 0; c < numClusters; c++) {
+        order[c] = c;
+    }
+    if (numClusters <= maxMetaTourClusters) {
+        twoOptCycle(centroids, order);
+    }
+
+    // Сшивка подмаршрутов: в каждом цикле разрезается ребро,
+    // дающее наименьшую стоимость входа и выхода
+    vector<int>& tour = result.tour;
+    tour.reserve(n);
+    vector<int> seams;
+    for (int p = 0; p < numClusters; p++) {
+        const vector<int>& cycle = cycles[order[p]];
+        const int m = cycle.size();
+        const bool hasPrev = !tour.empty();
+        const Point2D target = p + 1 < numClusters ? centroids[order[p + 1]] : points[tour[0]];
+
+        int bestCut = 0;
+        bool bestForward = true;
+        double bestCost = numeric_limits<double>::max();
+        for (int i = 0; i < m; i++) {
+            int u = cycle[i];
+            int v = cycle[(i + 1) % m];
+            double cut = m > 1 ? distance(points[u], points[v]) : 0;
+            // Вход в v, обход вперёд, выход из u
+            double forward = (hasPrev ? distance(points[tour.back()], points[v]) : 0) + distance(points[u], target) - cut;
+            // Вход в u, обход назад, выход из v
+            double backward = (hasPrev ? distance(points[tour.back()], points[u]) : 0) + distance(points[v], target) - cut;
+            if (forward < bestCost) {
+                bestCost = forward;
+                bestCut = i;
+                bestForward = true;
+            }
+            if (backward < bestCost) {
+                bestCost = backward;
+                bestCut = i;
+                bestForward = false;
+            }
+        }
+
+        seams.push_back(tour.size());
+        for (int k = 0; k < m; k++) {
+            int index = bestForward ? (bestCut + 1 + k) % m : (bestCut - k + m) % m;
+            tour.push_back(cycle[index]);
+        }
+    }
+    cycles.clear();
+
+    // Локальный поиск в окнах вокруг стыков
+    const int window = max(options.seamWindow, 2);
+    for (int s : seams) {
+        if (s > 0) {
+            twoOptWindow(points, tour, max(0, s - window), min(n, s + window));
+        }
+    }
+    // Стык между последним и первым кластером
+    const int wrap = min(window, n / 2);
+    rotate(tour.begin(), tour.end() - wrap, tour.end());
+    twoOptWindow(points, tour, 0, min(n, 2 * wrap));
+
+    result.length = tourLength(points, tour);
+    result.numClusters = numClusters;
+    return result;
+}
+
+bool loadPoints(const string& fileName, vector<Point2D>& points) {
+    ifstream file(fileName);
+    if (!file) {
+        return false;
+    }
+    points.clear();
+    string line;
+    while (getline(file, line)) {
+        replace(line.begin(), line.end(), ',', ' ');
+        replace(line.begin(), line.end(), ';', ' ');
+        // Пустые строки и комментарии пропускаются
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == string::npos || line[first] == '#') {
+            continue;
+        }
+        istringstream stream(line);
+        Point2D p;
+        if (!(stream >> p.x >> p.y)) {
+            return false;
+        }
+        points.push_back(p);
+    }
+    return true;
+}
+
+bool saveTour(const string& fileName, const vector<int>& tour) {
+    ofstream file(fileName);
+    if (!file) {
+        return false;
+    }
+    for (int v : tour) {
+        file << v << '\n';
+    }
+    return bool(file);
+}
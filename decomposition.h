@@ -0,0 +1,43 @@
+#ifndef DECOMPOSITION_H
+#define DECOMPOSITION_H
+
+#include <string>
+#include <vector>
+
+// Точка на плоскости (координаты вершины)
+struct Point2D {
+    double x;
+    double y;
+};
+
+// Параметры декомпозиционного решателя
+struct DecompositionOptions {
+    int clusterSize = 300;     // Примерный размер кластера
+    int seamWindow = 50;       // Полуширина окна локального поиска на стыках
+    int numThreads = 0;        // 0 - по числу ядер
+};
+
+// Результат декомпозиционного решателя
+struct DecompositionResult {
+    std::vector<int> tour;     // Порядок обхода вершин (замыкается на первую)
+    double length = 0;         // Длина замкнутого маршрута
+    int numClusters = 0;
+};
+
+// Решение задачи коммивояжёра для больших евклидовых экземпляров:
+// разбиение по кривой Гильберта, параллельное решение кластеров,
+// мета-маршрут по кластерам, сшивка и локальный поиск на стыках.
+// Память линейна по числу вершин - матрица смежности не строится.
+DecompositionResult solveByDecomposition(const std::vector<Point2D>& points,
+                                         const DecompositionOptions& options = DecompositionOptions());
+
+// Длина замкнутого маршрута по координатам
+double tourLength(const std::vector<Point2D>& points, const std::vector<int>& tour);
+
+// Чтение координат из текстового файла: по одной паре "x y" (или "x,y") в строке
+bool loadPoints(const std::string& fileName, std::vector<Point2D>& points);
+
+// Запись маршрута в текстовый файл: по одному номеру вершины в строке
+bool saveTour(const std::string& fileName, const std::vector<int>& tour);
+
+#endif // DECOMPOSITION_H
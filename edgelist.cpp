@@ -0,0 +1,170 @@
+#include "edgelist.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <thread>
+using namespace std;
+
+namespace {
+
+// Фрагменты меньше этого размера не разбираются в отдельном потоке
+const size_t minChunkSize = 1 << 20;
+
+struct Chunk {
+    const char* begin;
+    const char* end;
+    vector<Edge> edges;
+    int lines = 0;          // Число строк во фрагменте
+    int errorLine = -1;     // Номер строки с ошибкой внутри фрагмента
+};
+
+inline bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r';
+}
+
+inline const char* skipSeparators(const char* p, const char* end) {
+    while (p < end && isSeparator(*p)) {
+        p++;
+    }
+    return p;
+}
+
+// Чтение целого числа; from_chars не принимает ведущий '+', поэтому он пропускается
+inline from_chars_result parseInt(const char* p, const char* end, int& value) {
+    if (p < end && *p == '+') {
+        p++;
+    }
+    return from_chars(p, end, value);
+}
+
+// Разбор одной строки; false - строка не является ребром
+bool parseLine(const char* p, const char* end, Edge& edge, bool& skip) {
+    p = skipSeparators(p, end);
+    skip = p == end || *p == '#';
+    if (skip) {
+        return true;
+    }
+
+    from_chars_result r = parseInt(p, end, edge.v1);
+    if (r.ec != errc() || r.ptr == end || !isSeparator(*r.ptr)) {
+        return false;
+    }
+    p = skipSeparators(r.ptr, end);
+    r = parseInt(p, end, edge.v2);
+    if (r.ec != errc()) {
+        return false;
+    }
+    p = skipSeparators(r.ptr, end);
+    edge.weight = 1;
+    if (p < end && *p != '#') {
+        r = parseInt(p, end, edge.weight);
+        if (r.ec != errc()) {
+            return false;
+        }
+        p = skipSeparators(r.ptr, end);
+    }
+    return p == end || *p == '#';
+}
+
+void parseChunk(Chunk& chunk) {
+    chunk.edges.reserve((chunk.end - chunk.begin) / 12);
+    const char* p = chunk.begin;
+    while (p < chunk.end) {
+        const char* lineEnd = find(p, chunk.end, '\n');
+        Edge edge;
+        bool skip;
+        if (!parseLine(p, lineEnd, edge, skip)) {
+            chunk.errorLine = chunk.lines;
+            return;
+        }
+        if (!skip) {
+            chunk.edges.push_back(edge);
+        }
+        chunk.lines++;
+        p = lineEnd < chunk.end ? lineEnd + 1 : chunk.end;
+    }
+}
+
+} // namespace
+
+bool parseEdgeList(const string& text, vector<Edge>& edges, string& error) {
+    edges.clear();
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+
+    // Метка порядка байтов UTF-8 в начале файла пропускается
+    if (end - begin >= 3 && begin[0] == '\xEF' && begin[1] == '\xBB' && begin[2] == '\xBF') {
+        begin += 3;
+    }
+
+    // Первая строка, начинающаяся не с числа, - заголовок
+    const char* firstLineEnd = find(begin, end, '\n');
+    const char* first = skipSeparators(begin, firstLineEnd);
+    int headerLines = 0;
+    if (first < firstLineEnd && *first != '#' && !isdigit((unsigned char)*first) && *first != '-' && *first != '+') {
+        begin = firstLineEnd < end ? firstLineEnd + 1 : end;
+        headerLines = 1;
+    }
+
+    // Разбиение на фрагменты по границам строк
+    size_t size = end - begin;
+    int numThreads = max(1, int(thread::hardware_concurrency()));
+    numThreads = max(1, min(numThreads, int(size / minChunkSize)));
+    vector<Chunk> chunks;
+    const char* chunkBegin = begin;
+    for (int t = 0; t < numThreads; t++) {
+        const char* chunkEnd = t + 1 == numThreads ? end : begin + size * (t + 1) / numThreads;
+        chunkEnd = max(chunkEnd, chunkBegin);
+        if (chunkEnd < end) {
+            chunkEnd = find(chunkEnd, end, '\n');
+            chunkEnd = chunkEnd < end ? chunkEnd + 1 : end;
+        }
+        Chunk chunk;
+        chunk.begin = chunkBegin;
+        chunk.end = chunkEnd;
+        chunks.push_back(std::move(chunk));
+        chunkBegin = chunkEnd;
+    }
+
+    vector<thread> threads;
+    for (size_t c = 1; c < chunks.size(); c++) {
+        threads.emplace_back(parseChunk, ref(chunks[c]));
+    }
+    parseChunk(chunks[0]);
+    for (thread& t : threads) {
+        t.join();
+    }
+
+    // Сборка результата и поиск первой ошибки
+    size_t total = 0;
+    int line = headerLines;
+    for (const Chunk& chunk : chunks) {
+        if (chunk.errorLine != -1) {
+            ostringstream message;
+            message << "Ошибка в строке " << line + chunk.errorLine + 1;
+            error = message.str();
+            return false;
+        }
+        line += chunk.lines;
+        total += chunk.edges.size();
+    }
+    edges.reserve(total);
+    for (Chunk& chunk : chunks) {
+        edges.insert(edges.end(), chunk.edges.begin(), chunk.edges.end());
+        vector<Edge>().swap(chunk.edges);
+    }
+    return true;
+}
+
+bool loadEdgeList(const string& fileName, vector<Edge>& edges, string& error) {
+    ifstream file(fileName, ios::binary);
+    if (!file) {
+        error = "Не удалось открыть файл";
+        return false;
+    }
+    ostringstream buffer;
+    buffer << file.rdbuf();
+    return parseEdgeList(buffer.str(), edges, error);
+}
@@ -0,0 +1,20 @@
+#ifndef EDGELIST_H
+#define EDGELIST_H
+
+#include <string>
+#include <vector>
+#include "graph.h"
+
+// Чтение списка рёбер из файла: по одному ребру "v1 v2 [вес]" в строке,
+// разделители - пробелы, табуляция, запятая или точка с запятой.
+// Пустые строки и строки с '#' пропускаются, нечисловая первая строка
+// считается заголовком, метка порядка байтов UTF-8 пропускается.
+// Без веса ребро получает вес 1.
+// Файл разбирается параллельно по фрагментам; при ошибке в error
+// записывается её описание.
+bool loadEdgeList(const std::string& fileName, std::vector<Edge>& edges, std::string& error);
+
+// Разбор уже прочитанного текста списка рёбер
+bool parseEdgeList(const std::string& text, std::vector<Edge>& edges, std::string& error);
+
+#endif // EDGELIST_H
@@ -1,4 +1,5 @@
 #include "graph.h"
+#include "smalltsp.h"
 #include <QMessageBox>
 #include <queue>
 #include <stack>
@@ -26,10 +27,34 @@ int Graph::getEdgeWeight(int v1, int v2) const {
 
 //Добавление нового ребра в граф.
 void Graph::addEdge(int v1, int v2, int weight) {
+    if (v1 < 0 || v1 >= numVertices || v2 < 0 || v2 >= numVertices) {
+        QMessageBox::critical(nullptr, "Ошибка", "Неверные номера вершин");
+        return;
+    }
     adjacencyMatrix[v1][v2] = weight;
     adjacencyMatrix[v2][v1] = weight;
 }
 
+//Пакетная установка весов рёбер (вес 0 удаляет ребро).
+//Все рёбра проверяются до записи: при ошибке граф не изменяется.
+bool Graph::applyEdges(const vector<Edge>& edges) {
+    for (const Edge& edge : edges) {
+        if (edge.v1 < 0 || edge.v1 >= numVertices || edge.v2 < 0 || edge.v2 >= numVertices) {
+            QMessageBox::critical(nullptr, "Ошибка", "Неверные номера вершин");
+            return false;
+        }
+        if (edge.weight < 0) {
+            QMessageBox::critical(nullptr, "Ошибка", "Вес ребра не может быть отрицательным");
+            return false;
+        }
+    }
+    for (const Edge& edge : edges) {
+        adjacencyMatrix[edge.v1][edge.v2] = edge.weight;
+        adjacencyMatrix[edge.v2][edge.v1] = edge.weight;
+    }
+    return true;
+}
+
 //Возвращает вектор, содержащий все вершины графа
 vector<int> Graph::getVertices() const {
     vector<int> vertices(numVertices);
@@ -150,6 +175,31 @@ void Graph::depthFirstSearch(int startVertex) const {
 }
 
 void Graph::TSP(int startVertex) const {
+    if (startVertex < 0 || startVertex >= numVertices) {
+        QMessageBox::critical(nullptr, "Ошибка", "Неверный номер вершины");
+        return;
+    }
+
+    // Небольшие графы решаются точно специализированным решателем
+    if (numVertices >= 2 && numVertices <= maxSmallTSPVertices) {
+        std::array<int, maxSmallTSPVertices> exactPath;
+        auto weight = [this](int v1, int v2) { return adjacencyMatrix[v1][v2]; };
+        int64_t length = solveSmallTSP(numVertices, weight, startVertex, exactPath.data());
+        if (length < 0) {
+            QMessageBox::information(nullptr, "Результат", "Маршрут, проходящий через все вершины, не существует");
+            return;
+        }
+
+        QString message = "Минимальный путь, начинающийся с вершины " + QString::number(startVertex) + ": ";
+        for (int i = 0; i < numVertices; i++) {
+            message += QString::number(exactPath[i]) + " -> ";
+        }
+        message += QString::number(startVertex) + "\n";
+        message += "Общая длина пути: " + QString::number(length);
+        QMessageBox::information(nullptr, "Результат", message);
+        return;
+    }
+
     // Инициализация переменных
     vector<int> path;
     vector<bool> visited(numVertices, false);
@@ -3,6 +3,13 @@
 
 #include <vector>
 
+// Ребро для пакетного изменения графа
+struct Edge {
+    int v1;
+    int v2;
+    int weight;
+};
+
 class Graph {
 private:
     int numVertices;
@@ -18,6 +25,7 @@ public:
     int getNumVertices() const;
     int getEdgeWeight(int v1, int v2) const;
     void addEdge(int v1, int v2, int weight);
+    bool applyEdges(const std::vector<Edge>& edges);
     void breadthFirstSearch(int startVertex) const;
     void depthFirstSearch(int startVertex) const;
     void TSP(int startVertex) const;
@@ -0,0 +1,244 @@
+#include "graphlayout.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+using namespace std;
+
+namespace {
+
+// Глубина квадродерева ограничена, чтобы совпадающие точки не уводили рекурсию вглубь
+const int maxTreeDepth = 32;
+
+struct QuadNode {
+    double x0, y0, size;   // Квадрат, покрываемый узлом
+    double cx, cy;         // Центр масс
+    int mass;
+    int body;              // Вершина в листе, -1 если её нет
+    int child[4];
+};
+
+class QuadTree {
+public:
+    QuadTree(const vector<double>& xs, const vector<double>& ys) : xs(xs), ys(ys) {
+        const int n = xs.size();
+        double minX = xs[0], maxX = xs[0], minY = ys[0], maxY = ys[0];
+        for (int i = 1; i < n; i++) {
+            minX = min(minX, xs[i]);
+            maxX = max(maxX, xs[i]);
+            minY = min(minY, ys[i]);
+            maxY = max(maxY, ys[i]);
+        }
+        nodes.reserve(2 * n);
+        addNode(minX, minY, max(max(maxX - minX, maxY - minY), 1.0) * 1.0001);
+        for (int i = 0; i < n; i++) {
+            insert(i);
+        }
+    }
+
+    // Суммарная сила отталкивания k^2 / d, действующая на вершину v
+    void repulsion(int v, double k2, double theta2, double& fx, double& fy) const {
+        const double x = xs[v];
+        const double y = ys[v];
+        int stack[4 * maxTreeDepth + 4];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const QuadNode& node = nodes[stack[--top]];
+            if (node.mass == 0 || (node.body == v && node.mass == 1)) {
+                continue;
+            }
+            double dx = x - node.cx;
+            double dy = y - node.cy;
+            double d2 = dx * dx + dy * dy;
+            bool leaf = node.body != -1;
+            if (leaf || node.size * node.size < theta2 * d2) {
+                if (d2 < 1e-9) {
+                    // Совпадающие точки разводятся в детерминированном направлении
+                    dx = cos(v);
+                    dy = sin(v);
+                    d2 = 1;
+                }
+                double f = node.mass * k2 / d2;
+                fx += dx * f;
+                fy += dy * f;
+            } else {
+                for (int c = 0; c < 4; c++) {
+                    if (node.child[c] != -1) {
+                        stack[top++] = node.child[c];
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    const vector<double>& xs;
+    const vector<double>& ys;
+    vector<QuadNode> nodes;
+
+    int addNode(double x0, double y0, double size) {
+        nodes.push_back(QuadNode{x0, y0, size, 0, 0, 0, -1, {-1, -1, -1, -1}});
+        return nodes.size() - 1;
+    }
+
+    int quadrant(int node, int v) const {
+        const QuadNode& n = nodes[node];
+        double half = n.size / 2;
+        return (xs[v] >= n.x0 + half ? 1 : 0) + (ys[v] >= n.y0 + half ? 2 : 0);
+    }
+
+    int childFor(int node, int v) {
+        int q = quadrant(node, v);
+        if (nodes[node].child[q] == -1) {
+            double half = nodes[node].size / 2;
+            double x0 = nodes[node].x0 + (q & 1 ? half : 0);
+            double y0 = nodes[node].y0 + (q & 2 ? half : 0);
+            int child = addNode(x0, y0, half);
+            nodes[node].child[q] = child;
+        }
+        return nodes[node].child[q];
+    }
+
+    void addMass(int node, int v) {
+        QuadNode& n = nodes[node];
+        n.cx = (n.cx * n.mass + xs[v]) / (n.mass + 1);
+        n.cy = (n.cy * n.mass + ys[v]) / (n.mass + 1);
+        n.mass++;
+    }
+
+    void insert(int v) {
+        int node = 0;
+        for (int depth = 0; ; depth++) {
+            bool empty = nodes[node].mass == 0;
+            bool leaf = nodes[node].body != -1;
+            if (empty) {
+                addMass(node, v);
+                nodes[node].body = v;
+                return;
+            }
+            if (leaf) {
+                if (depth >= maxTreeDepth) {
+                    // Лист переполнен совпадающими точками - масса накапливается в нём
+                    addMass(node, v);
+                    return;
+                }
+                // Прежняя вершина листа опускается на уровень ниже
+                int old = nodes[node].body;
+                nodes[node].body = -1;
+                int child = childFor(node, old);
+                addMass(child, old);
+                nodes[child].body = old;
+            }
+            addMass(node, v);
+            node = childFor(node, v);
+        }
+    }
+};
+
+} // namespace
+
+vector<QPointF> forceDirectedLayout(const vector<QPointF>& initial,
+                                    const vector<pair<int, int>>& edges,
+                                    const vector<bool>& movable,
+                                    const LayoutOptions& options) {
+    const int n = initial.size();
+    if (n < 2) {
+        return initial;
+    }
+
+    vector<double> xs(n), ys(n);
+    double centerX = 0, centerY = 0;
+    for (int i = 0; i < n; i++) {
+        xs[i] = initial[i].x();
+        ys[i] = initial[i].y();
+        centerX += xs[i];
+        centerY += ys[i];
+    }
+    centerX /= n;
+    centerY /= n;
+
+    // Списки смежности в сжатом виде
+    vector<int> offsets(n + 1, 0);
+    for (const pair<int, int>& e : edges) {
+        offsets[e.first + 1]++;
+        offsets[e.second + 1]++;
+    }
+    for (int i = 0; i < n; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    vector<int> neighbours(offsets[n]);
+    vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (const pair<int, int>& e : edges) {
+        neighbours[fill[e.first]++] = e.second;
+        neighbours[fill[e.second]++] = e.first;
+    }
+
+    vector<int> active;
+    for (int i = 0; i < n; i++) {
+        if (movable[i]) {
+            active.push_back(i);
+        }
+    }
+    if (active.empty()) {
+        return initial;
+    }
+
+    const double k = options.idealEdgeLength;
+    const double k2 = k * k;
+    const double theta2 = options.theta * options.theta;
+    int numThreads = options.numThreads > 0 ? options.numThreads : int(thread::hardware_concurrency());
+    numThreads = max(1, min(numThreads, int(active.size() / 256) + 1));
+
+    vector<double> newXs(xs), newYs(ys);
+    for (int iteration = 0; iteration < options.iterations; iteration++) {
+        const double temperature = options.temperature * (1.0 - double(iteration) / options.iterations);
+        QuadTree tree(xs, ys);
+
+        auto step = [&](int first, int last) {
+            for (int a = first; a < last; a++) {
+                int v = active[a];
+                double fx = 0, fy = 0;
+                tree.repulsion(v, k2, theta2, fx, fy);
+                for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+                    int u = neighbours[e];
+                    double dx = xs[u] - xs[v];
+                    double dy = ys[u] - ys[v];
+                    double d = sqrt(dx * dx + dy * dy);
+                    fx += dx * d / k;
+                    fy += dy * d / k;
+                }
+                fx -= options.gravity * (xs[v] - centerX);
+                fy -= options.gravity * (ys[v] - centerY);
+
+                // Смещение ограничено текущей температурой
+                double length = sqrt(fx * fx + fy * fy);
+                if (length > 1e-9) {
+                    double move = min(length, temperature) / length;
+                    newXs[v] = xs[v] + fx * move;
+                    newYs[v] = ys[v] + fy * move;
+                }
+            }
+        };
+
+        const int count = active.size();
+        vector<thread> threads;
+        for (int t = 1; t < numThreads; t++) {
+            threads.emplace_back(step, int(int64_t(count) * t / numThreads), int(int64_t(count) * (t + 1) / numThreads));
+        }
+        step(0, int(int64_t(count) / numThreads));
+        for (thread& t : threads) {
+            t.join();
+        }
+
+        for (int v : active) {
+            xs[v] = newXs[v];
+            ys[v] = newYs[v];
+        }
+    }
+
+    vector<QPointF> result(n);
+    for (int i = 0; i < n; i++) {
+        result[i] = QPointF(xs[i], ys[i]);
+    }
+    return result;
+}
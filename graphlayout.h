@@ -0,0 +1,26 @@
+#ifndef GRAPHLAYOUT_H
+#define GRAPHLAYOUT_H
+
+#include <QPointF>
+#include <utility>
+#include <vector>
+
+// Параметры силовой укладки
+struct LayoutOptions {
+    int iterations = 300;
+    double idealEdgeLength = 120;   // Желаемая длина ребра
+    double theta = 0.8;             // Точность приближения Барнса-Хата
+    double temperature = 100;       // Начальное ограничение смещения за итерацию
+    double gravity = 0.01;          // Притяжение к центру, не даёт компонентам разлетаться
+    int numThreads = 0;             // 0 - по числу ядер
+};
+
+// Силовая укладка графа (Фрюхтерман-Рейнгольд) с отталкиванием по квадродереву
+// Барнса-Хата: O(n log n) на итерацию, силы считаются параллельно по вершинам.
+// Перемещаются только вершины с movable[v] == true, остальные служат опорой.
+std::vector<QPointF> forceDirectedLayout(const std::vector<QPointF>& initial,
+                                         const std::vector<std::pair<int, int>>& edges,
+                                         const std::vector<bool>& movable,
+                                         const LayoutOptions& options = LayoutOptions());
+
+#endif // GRAPHLAYOUT_H
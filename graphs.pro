@@ -1,6 +1,6 @@
 QT       += core gui
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent
 
 CONFIG += c++17
 
@@ -9,15 +9,24 @@ CONFIG += c++17
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    adjacencymatrixview.cpp \
+    decomposition.cpp \
+    edgelist.cpp \
     graph.cpp \
+    graphlayout.cpp \
     graphwidget.cpp \
     main.cpp \
     mainwindow.cpp
 
 HEADERS += \
+    adjacencymatrixview.h \
+    decomposition.h \
+    edgelist.h \
     graph.h \
+    graphlayout.h \
     graphwidget.h \
-    mainwindow.h
+    mainwindow.h \
+    smalltsp.h
 
 FORMS += \
     mainwindow.ui
@@ -10,69 +10,232 @@
 #include <QPointF>
 #include <QRectF>
 #include <QtMath>
+#include <QPainterPath>
 #include <cmath>
+#include <algorithm>
+#include <QtConcurrent>
+#include "graphlayout.h"
+
+namespace {
+
+// Размер сцены для начальной укладки по кругу
+const int sceneWidth = 1000;
+const int sceneHeight = 1000;
+
+// Число итераций при полном и при локальном пересчёте укладки
+const int fullLayoutIterations = 300;
+const int incrementalLayoutIterations = 100;
+
+// При большем числе рёбер они рисуются одним контуром без подписей весов
+const int maxLabelledEdges = 5000;
+
+}
+
+GraphWidget::GraphWidget(QWidget* parent)
+    : QGraphicsView(parent)
+    , shownGraph(nullptr)
+    , layoutDiscarded(false)
+    , layoutPending(false)
+{
+    setRenderHint(QPainter::Antialiasing);
+    setScene(new QGraphicsScene(this));
+    connect(&layoutWatcher, &QFutureWatcher<vector<QPointF>>::finished, this, &GraphWidget::layoutFinished);
+}
+
 void GraphWidget::reshGraph(const Graph& graph, const PathInfo& optimalPath) {
+    shownGraph = &graph;
+    shownPath = optimalPath.path;
+    syncPositions(graph);
+    redraw();
+    requestLayout(graph);
+}
 
+void GraphWidget::visGraph(const Graph& graph)
+{
+    shownGraph = &graph;
+    shownPath.clear();
+    syncPositions(graph);
+    redraw();
+    requestLayout(graph);
+}
 
-    // Очистить сцену
-    scene()->clear();
+// Сброс укладки, например при создании нового графа
+void GraphWidget::resetLayout() {
+    positions.clear();
+    dirty.clear();
+    removedDuringLayout.clear();
+    if (layoutWatcher.isRunning()) {
+        layoutDiscarded = true;
+    }
+}
+
+// Удаление положения вершины; соседние по сцене вершины будут уложены заново
+void GraphWidget::vertexRemoved(int vertex) {
+    if (vertex < 0 || vertex >= (int)positions.size()) {
+        return;
+    }
+    QPointF removed = positions[vertex];
+    positions.erase(positions.begin() + vertex);
+    dirty.erase(dirty.begin() + vertex);
 
-    // Получить количество вершин в графе
-    int numVertices = graph.getNumVertices();
+    const LayoutOptions options;
+    const qreal radius = 2 * options.idealEdgeLength;
+    for (size_t v = 0; v < positions.size(); v++) {
+        QPointF delta = positions[v] - removed;
+        if (QPointF::dotProduct(delta, delta) < radius * radius) {
+            dirty[v] = true;
+        }
+    }
 
-    // Вычислить положения вершин в круге для визуализации
-    const int sceneWidth = 1000;
-    const int sceneHeight = 1000;
-    const QPointF center(sceneWidth / 2, sceneHeight / 2);
-    const qreal radius = qMin(sceneWidth, sceneHeight) * 0.4;
-    const qreal angleIncrement = 2 * M_PI / numVertices;
+    if (layoutWatcher.isRunning()) {
+        removedDuringLayout.push_back(vertex);
+    }
+}
 
-    std::vector<QPointF> vertexPositions;
-    for (int i = 0; i < numVertices; i++) {
-        qreal angle = i * angleIncrement;
-        qreal x = center.x() + radius * qCos(angle);
-        qreal y = center.y() + radius * qSin(angle);
-        vertexPositions.emplace_back(x, y);
+// Концы добавленного или удалённого ребра будут уложены заново
+void GraphWidget::edgeChanged(int v1, int v2) {
+    if (v1 >= 0 && v1 < (int)dirty.size()) {
+        dirty[v1] = true;
     }
+    if (v2 >= 0 && v2 < (int)dirty.size()) {
+        dirty[v2] = true;
+    }
+}
 
-    // Нарисовать рёбра в графе
-    drawEdges(graph, vertexPositions);
+// Согласование сохранённых положений с числом вершин графа
+void GraphWidget::syncPositions(const Graph& graph) {
+    const int numVertices = graph.getNumVertices();
+    if ((int)positions.size() > numVertices) {
+        resetLayout();
+    }
 
-    // Нарисовать вершины в графе
-    drawVertices(vertexPositions);
+    // Начальная укладка вершин по кругу
+    if (positions.empty()) {
+        const QPointF center(sceneWidth / 2, sceneHeight / 2);
+        const qreal radius = qMin(sceneWidth, sceneHeight) * 0.4;
+        const qreal angleIncrement = 2 * M_PI / qMax(numVertices, 1);
+        for (int i = 0; i < numVertices; i++) {
+            qreal angle = i * angleIncrement;
+            positions.emplace_back(center.x() + radius * qCos(angle), center.y() + radius * qSin(angle));
+        }
+        dirty.assign(numVertices, true);
+        return;
+    }
 
-    // Нарисовать оптимальный путь
-    drawPath(optimalPath.path, vertexPositions);
+    // Новая вершина ставится рядом с уже уложенными соседями
+    QPointF centroid;
+    for (const QPointF& p : positions) {
+        centroid += p;
+    }
+    centroid /= positions.size();
+
+    const LayoutOptions options;
+    for (int v = positions.size(); v < numVertices; v++) {
+        QPointF position;
+        int placedNeighbours = 0;
+        for (int u = 0; u < v; u++) {
+            if (graph.getEdgeWeight(v, u) > 0) {
+                position += positions[u];
+                placedNeighbours++;
+            }
+        }
+        position = placedNeighbours > 0 ? position / placedNeighbours : centroid;
+        position += QPointF(qCos(v), qSin(v)) * options.idealEdgeLength / 2;
+        positions.push_back(position);
+        dirty.push_back(true);
+    }
 }
 
-void GraphWidget::visGraph(const Graph& graph)
-{
-    // Очистить сцену
-    scene()->clear();
+// Запуск фонового пересчёта укладки вокруг изменённых вершин
+void GraphWidget::requestLayout(const Graph& graph) {
+    if (std::find(dirty.begin(), dirty.end(), true) == dirty.end()) {
+        return;
+    }
+    if (layoutWatcher.isRunning()) {
+        layoutPending = true;
+        return;
+    }
+
+    const int numVertices = graph.getNumVertices();
+    vector<pair<int, int>> edges;
+    for (int v1 = 0; v1 < numVertices; v1++) {
+        for (int v2 = v1 + 1; v2 < numVertices; v2++) {
+            if (graph.getEdgeWeight(v1, v2) > 0) {
+                edges.emplace_back(v1, v2);
+            }
+        }
+    }
+
+    // Перемещаются изменённые вершины и их соседи
+    vector<bool> movable(dirty);
+    for (const pair<int, int>& e : edges) {
+        if (dirty[e.first]) {
+            movable[e.second] = true;
+        }
+        if (dirty[e.second]) {
+            movable[e.first] = true;
+        }
+    }
+
+    LayoutOptions options;
+    if (std::find(dirty.begin(), dirty.end(), false) == dirty.end()) {
+        options.iterations = fullLayoutIterations;
+    } else {
+        options.iterations = incrementalLayoutIterations;
+        options.temperature /= 2;
+    }
 
-    // Получить количество вершин в графе
-    int numVertices = graph.getNumVertices();
+    dirty.assign(numVertices, false);
+    removedDuringLayout.clear();
+    layoutDiscarded = false;
+    vector<QPointF> initial(positions);
+    layoutWatcher.setFuture(QtConcurrent::run([initial, edges, movable, options]() {
+        return forceDirectedLayout(initial, edges, movable, options);
+    }));
+}
+
+// Приём результата фонового расчёта
+void GraphWidget::layoutFinished() {
+    vector<QPointF> result = layoutWatcher.result();
+    if (!layoutDiscarded) {
+        // Вершины, добавленные и удалённые во время расчёта, в результате отсутствуют
+        for (int vertex : removedDuringLayout) {
+            if (vertex < (int)result.size()) {
+                result.erase(result.begin() + vertex);
+            }
+        }
+        // Вершины, добавленные во время расчёта, сохраняют свои положения
+        for (size_t v = 0; v < result.size() && v < positions.size(); v++) {
+            positions[v] = result[v];
+        }
+    }
+    removedDuringLayout.clear();
+    layoutDiscarded = false;
 
-    // Вычислить положения вершин в круге для визуализации
-    const int sceneWidth = 1000;
-    const int sceneHeight = 1000;
-    const QPointF center(sceneWidth / 2, sceneHeight / 2);
-    const qreal radius = qMin(sceneWidth, sceneHeight) * 0.4;
-    const qreal angleIncrement = 2 * M_PI / numVertices;
+    redraw();
+    if (layoutPending && shownGraph != nullptr) {
+        layoutPending = false;
+        requestLayout(*shownGraph);
+    }
+}
 
-    std::vector<QPointF> vertexPositions;
-    for (int i = 0; i < numVertices; i++) {
-        qreal angle = i * angleIncrement;
-        qreal x = center.x() + radius * qCos(angle);
-        qreal y = center.y() + radius * qSin(angle);
-        vertexPositions.emplace_back(x, y);
+// Перерисовка сцены по сохранённым положениям вершин
+void GraphWidget::redraw() {
+    if (shownGraph == nullptr || shownGraph->getNumVertices() != (int)positions.size()) {
+        return;
     }
 
+    // Очистить сцену
+    scene()->clear();
+
     // Нарисовать рёбра в графе
-    drawEdges(graph, vertexPositions);
+    drawEdges(*shownGraph, positions);
 
     // Нарисовать вершины в графе
-    drawVertices(vertexPositions);
+    drawVertices(positions);
+
+    // Нарисовать оптимальный путь
+    drawPath(shownPath, positions);
 }
 
 void GraphWidget::drawEdges(const Graph& graph, const std::vector<QPointF>& vertexPositions) {
@@ -81,20 +244,36 @@ void GraphWidget::drawEdges(const Graph& graph, const std::vector<QPointF>& vert
     QFont font("Arial", 10, QFont::Bold);
     QColor fontColor(255, 255, 0);
 
+    // Матрица симметрична, поэтому каждое ребро рисуется один раз
+    vector<pair<int, int>> edges;
     for (int v1 = 0; v1 < numVertices; v1++) {
-        for (int v2 = 0; v2 < numVertices; v2++) {
-            int weight = graph.getEdgeWeight(v1, v2);
-            if (weight > 0) {
-                QPointF p1 = vertexPositions[v1];
-                QPointF p2 = vertexPositions[v2];
-                QGraphicsLineItem* line = scene()->addLine(p1.x(), p1.y(), p2.x(), p2.y(), edgePen);
-                QGraphicsSimpleTextItem* text = scene()->addSimpleText(QString::number(weight));
-                text->setFont(font);
-                text->setBrush(fontColor);
-                text->setPos((p1 + p2) / 2);
+        for (int v2 = v1 + 1; v2 < numVertices; v2++) {
+            if (graph.getEdgeWeight(v1, v2) > 0) {
+                edges.emplace_back(v1, v2);
             }
         }
     }
+
+    // Большой граф: все рёбра одним элементом сцены
+    if ((int)edges.size() > maxLabelledEdges) {
+        QPainterPath edgePath;
+        for (const pair<int, int>& edge : edges) {
+            edgePath.moveTo(vertexPositions[edge.first]);
+            edgePath.lineTo(vertexPositions[edge.second]);
+        }
+        scene()->addPath(edgePath, edgePen);
+        return;
+    }
+
+    for (const pair<int, int>& edge : edges) {
+        QPointF p1 = vertexPositions[edge.first];
+        QPointF p2 = vertexPositions[edge.second];
+        scene()->addLine(p1.x(), p1.y(), p2.x(), p2.y(), edgePen);
+        QGraphicsSimpleTextItem* text = scene()->addSimpleText(QString::number(graph.getEdgeWeight(edge.first, edge.second)));
+        text->setFont(font);
+        text->setBrush(fontColor);
+        text->setPos((p1 + p2) / 2);
+    }
 }
 void GraphWidget::drawVertices(const std::vector<QPointF>& vertexPositions) {
     const int numVertices = vertexPositions.size();
@@ -14,6 +14,7 @@
 #include <QPointF>
 #include <QRectF>
 #include <QGraphicsTextItem>
+#include <QFutureWatcher>
 #include "graph.h"
 
 using namespace std;
@@ -30,19 +31,36 @@ class GraphWidget : public QGraphicsView
 {
     Q_OBJECT
 public:
-    GraphWidget(QWidget* parent = nullptr) : QGraphicsView(parent) {
-        setRenderHint(QPainter::Antialiasing);
-        setScene(new QGraphicsScene(this));
-    }
+    GraphWidget(QWidget* parent = nullptr);
 
     void reshGraph(const Graph& graph, const PathInfo& optimalPath);
     void visGraph(const Graph& graph);
 
+    // Уведомления об изменении графа для инкрементального пересчёта укладки
+    void resetLayout();
+    void vertexRemoved(int vertex);
+    void edgeChanged(int v1, int v2);
+
+private slots:
+    void layoutFinished();
+
 private:
+    void syncPositions(const Graph& graph);
+    void requestLayout(const Graph& graph);
+    void redraw();
     void drawEdges(const Graph& graph, const vector<QPointF>& vertexPositions);
     void drawVertices(const vector<QPointF>& vertexPositions);
     void drawPath(const vector<int>& path, const vector<QPointF>& vertexPositions);
     const int vertexLabelOffset = 5;
+
+    const Graph* shownGraph;            // Граф, отображаемый на сцене
+    vector<int> shownPath;              // Выделенный путь (пустой, если его нет)
+    vector<QPointF> positions;          // Сохранённые положения вершин
+    vector<bool> dirty;                 // Вершины, вокруг которых нужно пересчитать укладку
+    QFutureWatcher<vector<QPointF>> layoutWatcher;
+    vector<int> removedDuringLayout;    // Вершины, удалённые во время фонового расчёта
+    bool layoutDiscarded;               // Результат фонового расчёта устарел
+    bool layoutPending;                 // Нужен ещё один расчёт после текущего
 };
 
 #endif // GRAPHWIDGET_H
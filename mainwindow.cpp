@@ -1,5 +1,8 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "decomposition.h"
+#include "adjacencymatrixview.h"
+#include "edgelist.h"
 #include <iostream>
 #include <queue>
 #include <QMessageBox>
@@ -7,9 +10,15 @@
 #include <QIntValidator>
 #include <QInputDialog>
 #include <QVBoxLayout>
+#include <QFileDialog>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 using namespace std;
 
+// Наибольшее число вершин графа, создаваемого при импорте рёбер
+const int maxImportVertices = 10000;
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -34,6 +43,9 @@ MainWindow::MainWindow(QWidget *parent)
     // Подключение сигнала нажатия кнопки к слоту
     connect(TSPButton, &QPushButton::clicked, this, &MainWindow::TSP);
 
+    decompositionButton = new QPushButton("Декомпозиция", this);
+    connect(decompositionButton, &QPushButton::clicked, this, &MainWindow::decomposition);
+
     // Создание поля для ввода числа вершин
     vertexCountLineEdit = new QLineEdit(this);
     vertexCountLineEdit->setGeometry(100,100,300,100);
@@ -61,6 +73,9 @@ MainWindow::MainWindow(QWidget *parent)
     editEdgeWeightButton = new QPushButton("Изменить вес ребра", this);
     connect(editEdgeWeightButton, &QPushButton::clicked, this, &MainWindow::editWeight);
 
+    importEdgesButton = new QPushButton("Импорт рёбер", this);
+    connect(importEdgesButton, &QPushButton::clicked, this, &MainWindow::importEdges);
+
     // Создание горизонтального слоя для кнопок
     QHBoxLayout *buttonLayout = new QHBoxLayout;
     buttonLayout->addWidget(addVertexButton);
@@ -68,9 +83,11 @@ MainWindow::MainWindow(QWidget *parent)
     buttonLayout->addWidget(addEdgeButton);
     buttonLayout->addWidget(removeEdgeButton);
     buttonLayout->addWidget(editEdgeWeightButton);
+    buttonLayout->addWidget(importEdgesButton);
     buttonLayout->addWidget(breadthButton);
     buttonLayout->addWidget(depthButton);
     buttonLayout->addWidget(TSPButton);
+    buttonLayout->addWidget(decompositionButton);
     buttonLayout->addWidget(adjacencyMatrixButton);
 
     // Создание вертикального слоя для графического виджета и кнопок
@@ -92,6 +109,7 @@ MainWindow::MainWindow(QWidget *parent)
     breadthButton->setStyleSheet(style);
     depthButton->setStyleSheet(style);
     TSPButton->setStyleSheet(style);
+    decompositionButton->setStyleSheet(style);
     adjacencyMatrixButton->setStyleSheet(style);
     vertexCountLineEdit->setStyleSheet(style);
     addVertexButton->setStyleSheet(style);
@@ -99,6 +117,7 @@ MainWindow::MainWindow(QWidget *parent)
     removeEdgeButton->setStyleSheet(style);
     removeVertexButton->setStyleSheet(style);
     editEdgeWeightButton->setStyleSheet(style);
+    importEdgesButton->setStyleSheet(style);
     QPalette darkPalette;
     darkPalette.setColor(QPalette::Window, QColor(53, 53, 53));
     darkPalette.setColor(QPalette::WindowText, Qt::white);
@@ -144,6 +163,7 @@ void MainWindow::onVertexCountChanged(const QString& text)
 void MainWindow::updateGraph(int vertexCount)
 {
     graph = Graph(vertexCount);
+    graphWidget->resetLayout();
 
     if (vertexCount < 2) {
         QMessageBox::warning(this, "Ошибка", "Число вершин должно быть не менее 2.");
@@ -166,27 +186,42 @@ void MainWindow::updateGraph(int vertexCount)
 // Функция, которая выводит матрицу смежности на экран
 void MainWindow::showAdjacencyMatrix()
 {
-    int numVertices = graph.getNumVertices();
-    std::vector<std::vector<int>> adjacencyMatrix = graph.getAdjacencyMatrix();
-
-    QString matrixString;
-
-    // Формирование строки с матрицей смежности
-    for (int i = 0; i < numVertices; i++) {
-        for (int j = 0; j < numVertices; j++) {
-            matrixString += QString::number(adjacencyMatrix[i][j]) + "\t";
+    AdjacencyMatrixDialog dialog(graph, this);
+    dialog.exec();
+
+    // Перерисовка графа, если веса рёбер были изменены
+    const std::vector<std::pair<int, int>>& changedEdges = dialog.changedEdges();
+    if (!changedEdges.empty()) {
+        for (const std::pair<int, int>& edge : changedEdges) {
+            graphWidget->edgeChanged(edge.first, edge.second);
         }
-        matrixString += "\n";
+        graphWidget->visGraph(graph);
     }
-
-    // Отображение матрицы смежности в всплывающем окне
-    QMessageBox::information(this, "Матрица смежности", matrixString);
 }
 
 // Функция, которая позволяет добавить вершину в граф
 void MainWindow::addVertex() {
     graph.addVertex();
-    updateGraph(graph.getNumVertices());
+    int newVertex = graph.getNumVertices() - 1;
+
+    // Соединение новой вершины с уже существующими; остальной граф сохраняется
+    bool ok = newVertex > 0;
+    while (ok) {
+        QMessageBox::StandardButton reply = QMessageBox::question(this, "Добавление вершины", "Хотите соединить вершину " + QString::number(newVertex) + " ребром с другой вершиной?", QMessageBox::Yes | QMessageBox::No);
+        if (reply == QMessageBox::No) {
+            break;
+        }
+        int endVertex = QInputDialog::getInt(this, "Конечная вершина", "Введите номер вершины, с которой соединяется новая вершина", 0, 0, newVertex - 1, 1, &ok);
+        if (!ok) {
+            break;
+        }
+        int weight = QInputDialog::getInt(this, "Вес ребра", "Введите вес ребра", 0, 0, std::numeric_limits<int>::max(), 1, &ok);
+        if (!ok) {
+            break;
+        }
+        graph.addEdge(newVertex, endVertex, weight);
+        graphWidget->edgeChanged(newVertex, endVertex);
+    }
     graphWidget->visGraph(graph);
 }
 
@@ -198,6 +233,7 @@ void MainWindow::addEdge()
     int endVertex = QInputDialog::getInt(this, "Конечная вершина", "Введите номер конечной вершины для ребра", 0, 0, numVertices - 1, 1);
     int weight = QInputDialog::getInt(this, "Вес ребра", "Введите вес ребра", 0, 0, std::numeric_limits<int>::max(), 1);
     graph.addEdge(startikVertex, endVertex, weight);
+    graphWidget->edgeChanged(startikVertex, endVertex);
     graphWidget->visGraph(graph);
 }
 
@@ -210,6 +246,7 @@ void MainWindow::removeEdge()
         int startikVertex = QInputDialog::getInt(this, "Начальная вершина", "Введите номер начальной вершины для ребра", 0, 0, numVertices - 1, 1, &ok);
         int endVertex = QInputDialog::getInt(this, "Конечная вершина", "Введите номер конечной вершины для ребра", 0, 0, numVertices - 1, 1, &ok);
         graph.removeEdge(startikVertex, endVertex);
+        graphWidget->edgeChanged(startikVertex, endVertex);
         QMessageBox::StandardButton reply = QMessageBox::question(this, "Удаление ребра", "Хотите удалить еще одно ребро?", QMessageBox::Yes | QMessageBox::No);
         if (reply == QMessageBox::No) {
             ok = false;
@@ -224,6 +261,7 @@ void MainWindow::removeVertex()
     int numVertices = graph.getNumVertices();
     int Vertex = QInputDialog::getInt(this, "Вершина", "Введите номер удаляемой вершины", 0, 0, numVertices - 1, 1);
     graph.removeVertex(Vertex);
+    graphWidget->vertexRemoved(Vertex);
     graphWidget->visGraph(graph);
 }
 
@@ -235,6 +273,7 @@ void MainWindow::editWeight()
     int endVertex = QInputDialog::getInt(this, "Конечная вершина", "Введите номер конечной вершины для ребра", 0, 0, numVertices - 1, 1);
     int weight = QInputDialog::getInt(this, "Новый вес ребра", "Введите новый вес ребра", 0, 0, std::numeric_limits<int>::max(), 1);
     graph.editEdgeWeight(startikVertex, endVertex, weight);
+    graphWidget->edgeChanged(startikVertex, endVertex);
     graphWidget->visGraph(graph);
 }
 
@@ -264,3 +303,106 @@ void MainWindow::TSP()
     graph.TSP(startVertex);
     graphWidget->visGraph(graph);
 }
+
+// Функция, которая решает задачу коммивояжёра декомпозицией для координат из файла
+void MainWindow::decomposition()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Координаты вершин", QString(), "Текстовые файлы (*.txt *.csv);;Все файлы (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    std::vector<Point2D> points;
+    if (!loadPoints(fileName.toStdString(), points) || points.empty()) {
+        QMessageBox::critical(this, "Ошибка", "Не удалось прочитать координаты вершин");
+        return;
+    }
+
+    // Решение выполняется в фоновом потоке, чтобы не блокировать интерфейс
+    decompositionButton->setEnabled(false);
+    statusBar()->showMessage("Идёт решение задачи коммивояжёра декомпозицией...");
+    QElapsedTimer timer;
+    timer.start();
+    const int numPoints = points.size();
+    QFutureWatcher<DecompositionResult>* watcher = new QFutureWatcher<DecompositionResult>(this);
+    connect(watcher, &QFutureWatcher<DecompositionResult>::finished, this, [this, watcher, timer, numPoints]() {
+        DecompositionResult result = watcher->result();
+        watcher->deleteLater();
+        qint64 elapsed = timer.elapsed();
+        statusBar()->clearMessage();
+        decompositionButton->setEnabled(true);
+
+        QString message = "Число вершин: " + QString::number(numPoints) + "\n";
+        message += "Число кластеров: " + QString::number(result.numClusters) + "\n";
+        message += "Общая длина пути: " + QString::number(result.length, 'f', 2) + "\n";
+        message += "Время решения: " + QString::number(elapsed) + " мс\n\n";
+        message += "Сохранить маршрут в файл?";
+        QMessageBox::StandardButton reply = QMessageBox::question(this, "Результат", message, QMessageBox::Yes | QMessageBox::No);
+        if (reply == QMessageBox::No) {
+            return;
+        }
+
+        QString tourFileName = QFileDialog::getSaveFileName(this, "Сохранение маршрута", QString(), "Текстовые файлы (*.txt);;Все файлы (*)");
+        if (!tourFileName.isEmpty() && !saveTour(tourFileName.toStdString(), result.tour)) {
+            QMessageBox::critical(this, "Ошибка", "Не удалось сохранить маршрут");
+        }
+    });
+    watcher->setFuture(QtConcurrent::run([points = std::move(points)]() {
+        return solveByDecomposition(points);
+    }));
+}
+
+// Функция, которая загружает рёбра из файла одним пакетом
+void MainWindow::importEdges()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, "Список рёбер", QString(), "Текстовые файлы (*.txt *.csv);;Все файлы (*)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    std::vector<Edge> edges;
+    std::string error;
+    bool loaded = loadEdgeList(fileName.toStdString(), edges, error);
+    QApplication::restoreOverrideCursor();
+    if (!loaded) {
+        QMessageBox::critical(this, "Ошибка", QString::fromStdString(error));
+        return;
+    }
+
+    int maxVertex = -1;
+    for (const Edge& edge : edges) {
+        maxVertex = std::max(maxVertex, std::max(edge.v1, edge.v2));
+    }
+
+    // Рёбра, не помещающиеся в текущий граф, загружаются в новый граф
+    if (maxVertex >= graph.getNumVertices()) {
+        if (maxVertex >= maxImportVertices) {
+            QMessageBox::critical(this, "Ошибка", "Слишком большой номер вершины: " + QString::number(maxVertex));
+            return;
+        }
+        QMessageBox::StandardButton reply = QMessageBox::question(this, "Импорт рёбер", "Файл содержит вершины, которых нет в графе. Создать новый граф из " + QString::number(maxVertex + 1) + " вершин?", QMessageBox::Yes | QMessageBox::No);
+        if (reply == QMessageBox::No) {
+            return;
+        }
+
+        // Новый граф заменяет текущий только после успешной проверки всех рёбер
+        Graph importedGraph(maxVertex + 1);
+        if (!importedGraph.applyEdges(edges)) {
+            return;
+        }
+        graph = std::move(importedGraph);
+        graphWidget->resetLayout();
+        graphWidget->visGraph(graph);
+        return;
+    }
+
+    // Одна проверка, одна запись и одна перерисовка на весь файл
+    if (!graph.applyEdges(edges)) {
+        return;
+    }
+    for (const Edge& edge : edges) {
+        graphWidget->edgeChanged(edge.v1, edge.v2);
+    }
+    graphWidget->visGraph(graph);
+}
@@ -34,6 +34,8 @@ private slots:
     void breadth();
     void depth();
     void TSP();
+    void decomposition();
+    void importEdges();
 
 private:
     Ui::MainWindow *ui;
@@ -43,6 +45,8 @@ private:
     QPushButton* breadthButton;
     QPushButton* depthButton;
     QPushButton* TSPButton;
+    QPushButton* decompositionButton;
+    QPushButton* importEdgesButton;
     QLineEdit* vertexCountLineEdit;
     QPushButton* adjacencyMatrixButton;
     QPushButton* addVertexButton;
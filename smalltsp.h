@@ -0,0 +1,126 @@
+#ifndef SMALLTSP_H
+#define SMALLTSP_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+// Наибольшее число вершин, для которого задача коммивояжёра решается точно
+const int maxSmallTSPVertices = 12;
+
+// Точное решение задачи коммивояжёра для фиксированного числа вершин N
+// динамическим программированием по подмножествам (Хелд-Карп).
+// Все массивы имеют размер, известный при компиляции, и лежат на стеке -
+// выделений памяти в куче нет. Вес 0 между разными вершинами означает
+// отсутствие ребра.
+template <int N>
+struct SmallTSP {
+    static_assert(N >= 2 && N <= maxSmallTSPVertices, "SmallTSP: unsupported vertex count");
+
+    static constexpr int M = N - 1;           // Вершины, кроме начальной
+    static constexpr int numMasks = 1 << M;
+    static constexpr int64_t infinity = std::numeric_limits<int64_t>::max() / 4;
+
+    // Возвращает длину оптимального цикла или -1, если гамильтонова цикла нет
+    // или start не лежит в [0, N). path[0..N-1] - порядок обхода, начиная со start.
+    template <typename Weight>
+    static int64_t solve(const Weight& weight, int start, int* path) {
+        if (start < 0 || start >= N) {
+            return -1;
+        }
+
+        // Локальные номера: 0..M-1 - остальные вершины, M - начальная
+        std::array<int, N> vertices;
+        for (int v = 0, k = 0; v < N; v++) {
+            if (v != start) {
+                vertices[k++] = v;
+            }
+        }
+        vertices[M] = start;
+
+        std::array<std::array<int64_t, N>, N> cost;
+        for (int a = 0; a < N; a++) {
+            for (int b = 0; b < N; b++) {
+                int w = weight(vertices[a], vertices[b]);
+                cost[a][b] = (a != b && w <= 0) ? infinity : w;
+            }
+        }
+
+        // dp[mask][j] - кратчайший путь из начальной вершины через mask с концом в j
+        std::array<std::array<int64_t, M>, numMasks> dp;
+        for (int mask = 0; mask < numMasks; mask++) {
+            dp[mask].fill(infinity);
+        }
+        for (int j = 0; j < M; j++) {
+            dp[1 << j][j] = cost[M][j];
+        }
+        for (int mask = 1; mask < numMasks; mask++) {
+            for (int j = 0; j < M; j++) {
+                const int64_t current = dp[mask][j];
+                if (!(mask & (1 << j)) || current >= infinity) {
+                    continue;
+                }
+                for (int k = 0; k < M; k++) {
+                    if (mask & (1 << k)) {
+                        continue;
+                    }
+                    int64_t candidate = current + cost[j][k];
+                    int64_t& next = dp[mask | (1 << k)][k];
+                    if (candidate < next) {
+                        next = candidate;
+                    }
+                }
+            }
+        }
+
+        // Замыкание цикла в начальной вершине
+        const int full = numMasks - 1;
+        int last = -1;
+        int64_t best = infinity;
+        for (int j = 0; j < M; j++) {
+            int64_t total = dp[full][j] + cost[j][M];
+            if (total < best) {
+                best = total;
+                last = j;
+            }
+        }
+        if (last == -1) {
+            return -1;
+        }
+
+        // Восстановление пути по таблице без хранения предков
+        path[0] = start;
+        int mask = full;
+        int current = last;
+        for (int position = M; position >= 1; position--) {
+            path[position] = vertices[current];
+            int previousMask = mask ^ (1 << current);
+            if (previousMask == 0) {
+                break;
+            }
+            for (int i = 0; i < M; i++) {
+                if ((previousMask & (1 << i)) && dp[previousMask][i] + cost[i][current] == dp[mask][current]) {
+                    current = i;
+                    break;
+                }
+            }
+            mask = previousMask;
+        }
+        return best;
+    }
+};
+
+// Выбор специализации по числу вершин во время выполнения; -1, если число
+// вершин вне [2, maxSmallTSPVertices], начальная вершина неверна или цикла нет
+template <typename Weight, int N = 2>
+int64_t solveSmallTSP(int numVertices, const Weight& weight, int start, int* path) {
+    if (numVertices == N) {
+        return SmallTSP<N>::solve(weight, start, path);
+    }
+    if constexpr (N < maxSmallTSPVertices) {
+        return solveSmallTSP<Weight, N + 1>(numVertices, weight, start, path);
+    }
+    return -1;
+}
+
+#endif // SMALLTSP_H